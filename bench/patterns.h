@@ -0,0 +1,139 @@
+// Synthetic access-pattern generators for replacement policy benchmarking.
+// Every generator is deterministic (fixed seeds) so hit rates are comparable
+// run to run and against the stored baseline.
+#ifndef BENCH_PATTERNS_H
+#define BENCH_PATTERNS_H
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "cache.h"
+
+namespace bench
+{
+constexpr uint64_t BLOCK_SIZE = 64;
+
+struct access {
+  uint32_t cpu = 0;
+  uint64_t ip = 0;
+  uint64_t addr = 0;
+  access_type type = access_type::LOAD;
+};
+
+using trace = std::vector<access>;
+
+inline access make_access(uint64_t line, uint64_t ip, uint32_t cpu = 0, access_type type = access_type::LOAD)
+{
+  return {cpu, ip, line * BLOCK_SIZE, type};
+}
+
+// a1, a2, ..., ak, a1, a2, ... : thrashes any recency policy when k exceeds capacity
+inline trace cyclic(std::size_t n, uint64_t footprint_lines, uint64_t ip = 0x400000)
+{
+  trace t;
+  t.reserve(n);
+  for (std::size_t i = 0; i < n; ++i)
+    t.push_back(make_access(i % footprint_lines, ip));
+  return t;
+}
+
+// Cyclic pattern confined to a single set: consecutive lines are num_set apart
+inline trace single_set_cyclic(std::size_t n, uint64_t lines, uint64_t num_set, uint64_t ip = 0x400000)
+{
+  trace t;
+  t.reserve(n);
+  for (std::size_t i = 0; i < n; ++i)
+    t.push_back(make_access((i % lines) * num_set, ip));
+  return t;
+}
+
+// Random references to a hot working set, broken up by one-shot scans of never-reused lines
+inline trace scan_hot(std::size_t n, uint64_t hot_lines, uint64_t hot_burst, uint64_t scan_lines, uint64_t seed = 1)
+{
+  std::mt19937_64 rng(seed);
+  std::uniform_int_distribution<uint64_t> pick(0, hot_lines - 1);
+  const uint64_t scan_base = uint64_t{1} << 32;
+  uint64_t next_scan = 0;
+
+  trace t;
+  t.reserve(n);
+  while (t.size() < n) {
+    for (uint64_t i = 0; i < hot_burst && t.size() < n; ++i)
+      t.push_back(make_access(pick(rng), 0x401000));
+    for (uint64_t i = 0; i < scan_lines && t.size() < n; ++i)
+      t.push_back(make_access(scan_base + next_scan++, 0x402000));
+  }
+  return t;
+}
+
+// (a1, ..., ak, ak, ..., a1)^N : the most recently used lines are re-referenced first
+inline trace recency_friendly(std::size_t n, uint64_t k)
+{
+  trace t;
+  t.reserve(n);
+  while (t.size() < n) {
+    for (uint64_t i = 0; i < k && t.size() < n; ++i)
+      t.push_back(make_access(i, 0x403000));
+    for (uint64_t i = k; i > 0 && t.size() < n; --i)
+      t.push_back(make_access(i - 1, 0x403000));
+  }
+  return t;
+}
+
+// Repeated stream touching every stride-th line across a footprint
+inline trace strided(std::size_t n, uint64_t stride_lines, uint64_t footprint_lines)
+{
+  const uint64_t touched = footprint_lines / stride_lines;
+  trace t;
+  t.reserve(n);
+  for (std::size_t i = 0; i < n; ++i)
+    t.push_back(make_access((i % touched) * stride_lines, 0x404000));
+  return t;
+}
+
+// Hot lines are only touched by a few PCs, streaming lines by others; a PC-aware
+// predictor should learn to insert the streaming PCs at distant re-reference
+inline trace mixed_pc(std::size_t n, uint64_t hot_lines, double hot_fraction, unsigned hot_pcs, unsigned stream_pcs, uint64_t seed = 2)
+{
+  std::mt19937_64 rng(seed);
+  std::uniform_int_distribution<uint64_t> pick(0, hot_lines - 1);
+  std::uniform_real_distribution<double> coin(0.0, 1.0);
+  const uint64_t stream_base = uint64_t{1} << 33;
+  uint64_t next_stream = 0;
+
+  trace t;
+  t.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    if (coin(rng) < hot_fraction)
+      t.push_back(make_access(pick(rng), 0x500000 + 0x40 * (rng() % hot_pcs)));
+    else
+      t.push_back(make_access(stream_base + next_stream++, 0x600000 + 0x40 * (rng() % stream_pcs), 0, access_type::RFO));
+  }
+  return t;
+}
+
+// Round-robin interleaving of per-core traces; each core gets a disjoint address range
+inline trace interleave(const std::vector<trace>& per_core)
+{
+  std::size_t total = 0;
+  for (const auto& core : per_core)
+    total += core.size();
+
+  trace t;
+  t.reserve(total);
+  for (std::size_t i = 0; t.size() < total; ++i) {
+    for (uint32_t cpu = 0; cpu < per_core.size(); ++cpu) {
+      if (i < per_core[cpu].size()) {
+        auto a = per_core[cpu][i];
+        a.cpu = cpu;
+        a.addr += (uint64_t{cpu} + 1) << 40;
+        t.push_back(a);
+      }
+    }
+  }
+  return t;
+}
+} // namespace bench
+
+#endif
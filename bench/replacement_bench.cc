@@ -0,0 +1,597 @@
+// Synthetic benchmark for the policies in replacement/.
+//
+// Each policy is constructed against a stub CACHE and driven through its module
+// interface (find_victim / update_replacement_state / replacement_cache_fill) the
+// same way ChampSim's CACHE does: hits call update_replacement_state, misses fill an
+// invalid way if one exists and otherwise ask the policy for a victim, then call
+// replacement_cache_fill. A policy without a fill hook never hears about misses,
+// exactly as in the simulator, and fails the fill-delivery known-answer check.
+//
+// Build from the repository root:
+//   g++ -std=c++20 -O2 -pthread -Ibench/stub -Ireplacement bench/replacement_bench.cc replacement/*.cc -o replacement_bench
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "drrip.h"
+#include "eship.h"
+#include "lru.h"
+#include "patterns.h"
+#include "seg_lru.h"
+
+// drrip sizes its tables for a 2048-set, 16-way LLC regardless of the CACHE it
+// is given, so every policy is benchmarked on that geometry
+constexpr long NUM_SET = 2048;
+constexpr long NUM_WAY = 16;
+constexpr uint64_t CAPACITY = NUM_SET * NUM_WAY;
+
+// Live heap bytes, tracked by replacing the global allocator. The policy state
+// size is the growth of this value across the policy's construction and run.
+// Atomic because the telemetry checks run a writer thread that allocates too.
+static std::atomic<std::size_t> live_heap_bytes{0};
+
+namespace
+{
+constexpr std::size_t ALLOC_HEADER = alignof(std::max_align_t);
+
+void* counted_alloc(std::size_t size)
+{
+  auto* p = static_cast<unsigned char*>(std::malloc(size + ALLOC_HEADER));
+  if (p == nullptr)
+    throw std::bad_alloc{};
+  *reinterpret_cast<std::size_t*>(p) = size;
+  live_heap_bytes.fetch_add(size, std::memory_order_relaxed);
+  return p + ALLOC_HEADER;
+}
+
+void counted_free(void* ptr)
+{
+  if (ptr == nullptr)
+    return;
+  auto* p = static_cast<unsigned char*>(ptr) - ALLOC_HEADER;
+  live_heap_bytes.fetch_sub(*reinterpret_cast<std::size_t*>(p), std::memory_order_relaxed);
+  std::free(p);
+}
+} // namespace
+
+void* operator new(std::size_t size) { return counted_alloc(size); }
+void* operator new[](std::size_t size) { return counted_alloc(size); }
+void operator delete(void* ptr) noexcept { counted_free(ptr); }
+void operator delete[](void* ptr) noexcept { counted_free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { counted_free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { counted_free(ptr); }
+
+struct result {
+  uint64_t accesses = 0;
+  uint64_t hits = 0;
+  uint64_t fills = 0; // misses delivered to the policy through replacement_cache_fill
+  double ns_per_access = 0; // whole replay; main() subtracts the null_policy replay of the same trace
+  std::size_t state_bytes = 0;
+
+  double hit_rate() const { return accesses == 0 ? 0 : 100.0 * static_cast<double>(hits) / static_cast<double>(accesses); }
+};
+
+// ChampSim has no fallback for modules without a fill hook: the fill is simply not reported
+template <typename P>
+bool fill(P& policy, uint32_t cpu, long set, long way, champsim::address addr, champsim::address ip, champsim::address victim_addr, access_type type)
+{
+  if constexpr (requires { policy.replacement_cache_fill(cpu, set, way, addr, ip, victim_addr, type); }) {
+    policy.replacement_cache_fill(cpu, set, way, addr, ip, victim_addr, type);
+    return true;
+  }
+  return false;
+}
+
+// Replay a trace against the cache, calling the policy hooks; counts hits and fills into res
+template <typename P>
+void drive(P& policy, CACHE& cache, const bench::trace& t, result& res)
+{
+  uint64_t instr_id = 0;
+  for (const auto& a : t) {
+    const uint64_t line = a.addr / bench::BLOCK_SIZE;
+    const long set = static_cast<long>(line % NUM_SET);
+    auto* set_begin = &cache.block[static_cast<std::size_t>(set * NUM_WAY)];
+    auto* set_end = set_begin + NUM_WAY;
+    const champsim::address addr{a.addr};
+    const champsim::address ip{a.ip};
+
+    auto* way = std::find_if(set_begin, set_end, [line](const auto& b) { return b.valid && b.address.template to<uint64_t>() / bench::BLOCK_SIZE == line; });
+    if (way != set_end) {
+      ++res.hits;
+      policy.update_replacement_state(a.cpu, set, std::distance(set_begin, way), addr, ip, {}, a.type, 1);
+    } else {
+      way = std::find_if_not(set_begin, set_end, [](const auto& b) { return b.valid; });
+      if (way == set_end)
+        way = set_begin + policy.find_victim(a.cpu, instr_id, set, set_begin, ip, addr, a.type);
+
+      const auto victim_addr = way->address;
+      if (fill(policy, a.cpu, set, std::distance(set_begin, way), addr, ip, victim_addr, a.type))
+        ++res.fills;
+      way->valid = true;
+      way->address = addr;
+    }
+    ++instr_id;
+  }
+}
+
+template <typename P>
+result run(const bench::trace& t)
+{
+  CACHE cache{"LLC", NUM_SET, NUM_WAY};
+  result res;
+
+  const auto heap_before = live_heap_bytes.load();
+  auto policy = std::make_unique<P>(&cache);
+
+  const auto start = std::chrono::steady_clock::now();
+  drive(*policy, cache, t, res);
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+
+  res.accesses = t.size();
+  res.ns_per_access = std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(std::max<std::size_t>(t.size(), 1));
+  res.state_bytes = live_heap_bytes - heap_before;
+  return res;
+}
+
+// Does nothing, so a run with it times only the harness's tag lookup and block updates
+struct null_policy : champsim::modules::replacement {
+  explicit null_policy(CACHE* cache) : replacement(cache) {}
+
+  long find_victim(uint32_t, uint64_t, long, const champsim::cache_block*, champsim::address, champsim::address, access_type) { return 0; }
+  void update_replacement_state(uint32_t, long, long, champsim::address, champsim::address, champsim::address, access_type, uint8_t) {}
+  void replacement_cache_fill(uint32_t, long, long, champsim::address, champsim::address, champsim::address, access_type) {}
+};
+
+struct policy_entry {
+  std::string name;
+  result (*run)(const bench::trace&);
+};
+
+const std::vector<policy_entry> policies{{"lru", run<lru>}, {"seg_lru", run<seg_lru>}, {"drrip", run<drrip>}, {"eship", run<eship>}};
+
+struct pattern_entry {
+  std::string name;
+  bench::trace t;
+};
+
+std::vector<pattern_entry> make_patterns(std::size_t n)
+{
+  std::vector<pattern_entry> patterns;
+  patterns.push_back({"cyclic_1.5x", bench::cyclic(n, CAPACITY + CAPACITY / 2)});
+  patterns.push_back({"scan_hot", bench::scan_hot(n, CAPACITY / 2, CAPACITY, CAPACITY / 2)});
+  patterns.push_back({"recency", bench::recency_friendly(n, CAPACITY + CAPACITY / 4)});
+  patterns.push_back({"strided_s4", bench::strided(n, 4, CAPACITY * 2)});
+  patterns.push_back({"strided_s17", bench::strided(n, 17, CAPACITY * 8)});
+  patterns.push_back({"mixed_pc", bench::mixed_pc(n, CAPACITY / 2, 0.5, 4, 16)});
+
+  const std::size_t per_core = n / NUM_CPUS;
+  std::vector<bench::trace> cores;
+  for (std::size_t cpu = 0; cpu < NUM_CPUS; ++cpu) {
+    switch (cpu % 4) {
+    case 0:
+      cores.push_back(bench::scan_hot(per_core, CAPACITY / 8, CAPACITY / 4, CAPACITY / 8, cpu + 1));
+      break;
+    case 1:
+      cores.push_back(bench::cyclic(per_core, CAPACITY / 2));
+      break;
+    case 2:
+      cores.push_back(bench::mixed_pc(per_core, CAPACITY / 8, 0.5, 4, 16, cpu + 1));
+      break;
+    default:
+      cores.push_back(bench::recency_friendly(per_core, CAPACITY / 4));
+    }
+  }
+  patterns.push_back({"multicore", bench::interleave(cores)});
+  return patterns;
+}
+
+// Known-answer checks; returns the number of failures
+int run_known_answers()
+{
+  struct check {
+    std::string policy;
+    std::string what;
+    result (*run)(const bench::trace&);
+    bench::trace t;
+    uint64_t expected_hits;
+  };
+
+  constexpr std::size_t n = 10000;
+  std::vector<check> checks;
+
+  // LRU always evicts the line that is needed next on a W+1 cycle
+  checks.push_back({"lru", "single-set cycle of W+1 lines has 0 hits", run<lru>, bench::single_set_cyclic(n, NUM_WAY + 1, NUM_SET), 0});
+  checks.push_back({"lru", "cycle of capacity+sets lines has 0 hits", run<lru>, bench::cyclic(n * 8, CAPACITY + NUM_SET), 0});
+
+  // Any policy must hit on everything but cold misses once the footprint fits
+  for (const auto& p : policies) {
+    checks.push_back({p.name, "single-set cycle of W lines misses only cold", p.run, bench::single_set_cyclic(n, NUM_WAY, NUM_SET), n - NUM_WAY});
+    checks.push_back({p.name, "cycle of capacity lines misses only cold", p.run, bench::cyclic(CAPACITY * 3, CAPACITY), CAPACITY * 2});
+  }
+
+  int failures = 0;
+  for (const auto& c : checks) {
+    const auto res = c.run(c.t);
+    const bool ok = res.hits == c.expected_hits;
+    std::cout << (ok ? "PASS " : "FAIL ") << std::left << std::setw(8) << c.policy << " " << c.what;
+    if (!ok)
+      std::cout << " (expected " << c.expected_hits << " hits, got " << res.hits << ")";
+    std::cout << std::endl;
+    failures += ok ? 0 : 1;
+  }
+
+  // Every miss the harness sees must reach the policy, or its predictions are built on hits alone
+  const auto mixed = bench::cyclic(CAPACITY * 3, CAPACITY + CAPACITY / 2);
+  for (const auto& p : policies) {
+    const auto res = p.run(mixed);
+    const bool ok = res.fills == res.accesses - res.hits;
+    std::cout << (ok ? "PASS " : "FAIL ") << std::left << std::setw(8) << p.name << " every miss is delivered as a fill";
+    if (!ok)
+      std::cout << " (" << res.accesses - res.hits << " misses, " << res.fills << " fills)";
+    std::cout << std::endl;
+    failures += ok ? 0 : 1;
+  }
+  return failures;
+}
+
+// Print one PASS/FAIL line; returns 1 on failure so callers can sum failures
+int report(bool ok, const std::string& subject, const std::string& what, const std::string& detail = "")
+{
+  std::cout << (ok ? "PASS " : "FAIL ") << std::left << std::setw(8) << subject << " " << what;
+  if (!ok && !detail.empty())
+    std::cout << " (" << detail << ")";
+  std::cout << std::endl;
+  return ok ? 0 : 1;
+}
+
+// Contents of a .rptl file, see the layout in replacement/telemetry.h
+struct telemetry_file {
+  std::vector<std::string> names;
+  std::vector<uint64_t> stamps;
+  std::vector<std::vector<float>> columns;
+  uint64_t dropped = 0;
+};
+
+// Parse a telemetry file; returns an empty string on success, otherwise what was malformed
+std::string read_telemetry(const std::filesystem::path& path, telemetry_file& file)
+{
+  std::ifstream in{path, std::ios::binary};
+  if (!in)
+    return "cannot open " + path.string();
+
+  auto get = [&in](auto& value) { return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(value))); };
+
+  char magic[4];
+  uint32_t version = 0, column_count = 0;
+  if (!in.read(magic, 4) || std::memcmp(magic, "RPTL", 4) != 0 || !get(version) || version != 1 || !get(column_count))
+    return "bad header";
+
+  for (uint32_t c = 0; c < column_count; ++c) {
+    uint16_t length = 0;
+    std::string name;
+    if (!get(length))
+      return "truncated column names";
+    name.resize(length);
+    if (!in.read(name.data(), length))
+      return "truncated column names";
+    file.names.push_back(name);
+  }
+  file.columns.resize(column_count);
+
+  while (true) {
+    uint32_t rows = 0;
+    if (!get(rows))
+      return "missing 0 terminator";
+    if (rows == 0)
+      break;
+    for (uint32_t r = 0; r < rows; ++r) {
+      uint64_t stamp;
+      if (!get(stamp))
+        return "truncated block";
+      file.stamps.push_back(stamp);
+    }
+    for (auto& column : file.columns) {
+      for (uint32_t r = 0; r < rows; ++r) {
+        float value;
+        if (!get(value))
+          return "truncated block";
+        column.push_back(value);
+      }
+    }
+  }
+
+  if (!get(file.dropped))
+    return "missing dropped count";
+  if (in.peek() != std::char_traits<char>::eof())
+    return "trailing bytes after trailer";
+  return "";
+}
+
+// Round-trip a policy's telemetry: build it with REPLACEMENT_TELEMETRY_DIR set, move it
+// (as ChampSim's module tuple does), replay the trace, destroy it and parse the file back
+template <typename P>
+int check_telemetry_file(const std::string& name, const std::filesystem::path& dir, const bench::trace& t,
+                         const std::vector<std::string>& expected_names)
+{
+  const auto path = dir / (name + ".LLC.rptl");
+  {
+    CACHE cache{"LLC", NUM_SET, NUM_WAY};
+    P constructed{&cache};
+    auto policy = std::make_unique<P>(std::move(constructed));
+    result res;
+    drive(*policy, cache, t, res);
+  }
+
+  telemetry_file file;
+  if (auto error = read_telemetry(path, file); !error.empty())
+    return report(false, name, "telemetry file parses back", error);
+
+  int failures = report(true, name, "telemetry file parses back");
+  failures += report(file.names == expected_names, name, "telemetry column names match");
+
+  const auto expected_rows = t.size() / telemetry::SAMPLE_INTERVAL;
+  failures += report(file.stamps.size() == expected_rows, name, "one telemetry row per sample interval",
+                     std::to_string(file.stamps.size()) + " rows, expected " + std::to_string(expected_rows));
+
+  bool evenly_spaced = true;
+  for (std::size_t r = 0; r < file.stamps.size(); ++r)
+    evenly_spaced = evenly_spaced && file.stamps[r] == (r + 1) * telemetry::SAMPLE_INTERVAL;
+  failures += report(evenly_spaced, name, "telemetry stamps increase by the sample interval");
+
+  // Every CPU and the sampler see accesses in every interval of these traces, so no rate may be NaN
+  bool rates_defined = true;
+  for (std::size_t c = 0; c < file.names.size(); ++c)
+    if (file.names[c].find("hit_rate") != std::string::npos)
+      rates_defined = rates_defined && std::none_of(std::begin(file.columns[c]), std::end(file.columns[c]), [](float v) { return std::isnan(v); });
+  failures += report(rates_defined, name, "telemetry rates are defined in every row");
+
+  failures += report(file.dropped == 0, name, "no telemetry rows dropped", std::to_string(file.dropped) + " dropped");
+  return failures;
+}
+
+// Telemetry checks: the ring itself, then a file round trip for each policy that records
+int run_telemetry_checks()
+{
+  int failures = 0;
+
+  // Fill a small ring past capacity, then wrap it around and check FIFO order
+  {
+    telemetry::ring r{8, 2};
+    bool ok = true;
+    for (uint64_t i = 0; i < 8; ++i) {
+      const float row[2] = {static_cast<float>(i), static_cast<float>(i) + 0.5f};
+      ok = ok && r.try_push(i, row);
+    }
+    const float extra[2] = {99, 99};
+    ok = ok && !r.try_push(99, extra);
+
+    uint64_t stamp;
+    float out[2];
+    for (uint64_t i = 0; i < 3; ++i)
+      ok = ok && r.try_pop(stamp, out) && stamp == i && out[0] == static_cast<float>(i) && out[1] == static_cast<float>(i) + 0.5f;
+    for (uint64_t i = 8; i < 11; ++i) {
+      const float row[2] = {static_cast<float>(i), static_cast<float>(i) + 0.5f};
+      ok = ok && r.try_push(i, row);
+    }
+    ok = ok && !r.try_push(99, extra);
+    for (uint64_t i = 3; i < 11; ++i)
+      ok = ok && r.try_pop(stamp, out) && stamp == i && out[0] == static_cast<float>(i) && out[1] == static_cast<float>(i) + 0.5f;
+    ok = ok && !r.try_pop(stamp, out);
+    failures += report(ok, "ring", "rejects pushes when full and pops in order across wrap-around");
+  }
+
+  char dir_template[] = "/tmp/replacement_bench.XXXXXX";
+  if (mkdtemp(dir_template) == nullptr)
+    return failures + report(false, "bench", "create telemetry directory", std::strerror(errno));
+  const std::filesystem::path dir{dir_template};
+  setenv("REPLACEMENT_TELEMETRY_DIR", dir.c_str(), 1);
+
+  const auto samples = 12 * telemetry::SAMPLE_INTERVAL;
+  failures += check_telemetry_file<drrip>("drrip", dir, bench::cyclic(samples + 5, CAPACITY + CAPACITY / 2),
+                                          {"hit_rate", "psel_min", "psel_mean", "psel_max", "psel_srrip_groups", "rrpv_0", "rrpv_1", "rrpv_2", "rrpv_3",
+                                           "bip_inserts", "srrip_inserts"});
+
+  // Interleaved CPUs must still yield one row per interval of the summed access count
+  std::vector<bench::trace> cores(NUM_CPUS, bench::cyclic(samples / NUM_CPUS, CAPACITY / NUM_CPUS));
+  std::vector<std::string> eship_names;
+  for (std::size_t cpu = 0; cpu < NUM_CPUS; ++cpu)
+    for (const auto* column : {"hit_rate", "weight_load", "weight_rfo", "weight_prefetch", "weight_write"})
+      eship_names.push_back("cpu" + std::to_string(cpu) + "_" + column);
+  eship_names.push_back("sampler_hit_rate");
+  for (unsigned i = 0; i <= eship::SHCT_MAX; ++i)
+    eship_names.push_back("shct_" + std::to_string(i));
+  for (int i = 0; i <= eship::maxRRPV; ++i)
+    eship_names.push_back("rrpv_" + std::to_string(i));
+  failures += check_telemetry_file<eship>("eship", dir, bench::interleave(cores), eship_names);
+
+  unsetenv("REPLACEMENT_TELEMETRY_DIR");
+  std::filesystem::remove_all(dir);
+  return failures;
+}
+
+struct baseline_entry {
+  uint64_t accesses;
+  double hit_rate;
+  double ns_per_access;
+  std::size_t state_bytes;
+};
+
+// Baseline format, one line per policy/pattern pair ('#' starts a comment):
+//   <policy> <pattern> <accesses> <hit rate %> <ns per access> <state bytes>
+std::map<std::string, baseline_entry> read_baseline(const std::string& path)
+{
+  std::map<std::string, baseline_entry> baseline;
+  std::ifstream in{path};
+  if (!in) {
+    std::cerr << "Could not open baseline " << path << std::endl;
+    std::exit(2);
+  }
+
+  std::string line;
+  while (std::getline(in, line)) {
+    if (line.empty() || line[0] == '#')
+      continue;
+    std::istringstream fields{line};
+    std::string policy, pattern;
+    baseline_entry e{};
+    if (fields >> policy >> pattern >> e.accesses >> e.hit_rate >> e.ns_per_access >> e.state_bytes)
+      baseline[policy + " " + pattern] = e;
+  }
+  return baseline;
+}
+
+void usage(const char* prog)
+{
+  std::cerr << "Usage: " << prog << " [--accesses N] [--policy NAME] [--baseline FILE] [--write-baseline FILE] [--hit-tolerance PCT]" << std::endl;
+}
+
+// Parse a whole argument as a number no smaller than minimum; false on junk, trailing characters or overflow
+template <typename T>
+bool parse_number(const std::string& text, T& value, T minimum)
+{
+  if (text.empty() || text[0] == '-') // istream wraps negative input into unsigned types
+    return false;
+  std::istringstream in{text};
+  return (in >> value) && in.peek() == std::char_traits<char>::eof() && value >= minimum;
+}
+
+int main(int argc, char** argv)
+{
+  // Telemetry would inflate state_bytes with its ring and buffers and overwrite
+  // the same file on every run, so the benchmark runs the policies without it;
+  // run_telemetry_checks() turns it on in a private directory of its own
+  unsetenv("REPLACEMENT_TELEMETRY_DIR");
+
+  std::size_t accesses = 1000000;
+  std::string only_policy, baseline_path, write_path;
+  double hit_tolerance = 1.0; // percentage points of hit rate
+  constexpr double STATE_TOLERANCE = 1.10;
+  constexpr double TIME_TOLERANCE = 2.0;
+
+  for (int i = 1; i < argc; ++i) {
+    std::string arg{argv[i]};
+    if (i + 1 >= argc) {
+      usage(argv[0]);
+      return 2;
+    }
+    if (arg == "--accesses") {
+      if (!parse_number(argv[++i], accesses, std::size_t{1})) {
+        usage(argv[0]);
+        return 2;
+      }
+    } else if (arg == "--policy") {
+      only_policy = argv[++i];
+      if (std::none_of(std::begin(policies), std::end(policies), [&only_policy](const auto& p) { return p.name == only_policy; })) {
+        std::cerr << "Unknown policy " << only_policy << std::endl;
+        usage(argv[0]);
+        return 2;
+      }
+    } else if (arg == "--baseline")
+      baseline_path = argv[++i];
+    else if (arg == "--write-baseline")
+      write_path = argv[++i];
+    else if (arg == "--hit-tolerance") {
+      if (!parse_number(argv[++i], hit_tolerance, 0.0)) {
+        usage(argv[0]);
+        return 2;
+      }
+    } else {
+      usage(argv[0]);
+      return 2;
+    }
+  }
+
+  int failures = run_known_answers();
+  failures += run_telemetry_checks();
+
+  std::map<std::string, baseline_entry> baseline;
+  if (!baseline_path.empty())
+    baseline = read_baseline(baseline_path);
+
+  std::ofstream out;
+  if (!write_path.empty()) {
+    out.open(write_path);
+    if (!out) {
+      std::cerr << "Could not open " << write_path << " for writing" << std::endl;
+      return 2;
+    }
+    out << "# policy pattern accesses hit_rate ns_per_access state_bytes" << std::endl;
+  }
+
+  std::cout << std::endl
+            << std::left << std::setw(9) << "policy" << std::setw(13) << "pattern" << std::right << std::setw(10) << "accesses" << std::setw(10) << "hit%"
+            << std::setw(10) << "ns/acc" << std::setw(12) << "state_B"
+            << "  status" << std::endl;
+
+  const auto patterns = make_patterns(accesses);
+
+  // Harness cost per access for each pattern, subtracted so ns/acc is the policy's own cost
+  std::map<std::string, double> harness_ns;
+  for (const auto& pat : patterns)
+    harness_ns[pat.name] = run<null_policy>(pat.t).ns_per_access;
+  for (const auto& p : policies) {
+    if (!only_policy.empty() && p.name != only_policy)
+      continue;
+
+    for (const auto& pat : patterns) {
+      auto res = p.run(pat.t);
+      res.ns_per_access = std::max(0.0, res.ns_per_access - harness_ns[pat.name]);
+
+      std::string status = "ok";
+      if (auto found = baseline.find(p.name + " " + pat.name); found != baseline.end()) {
+        const auto& base = found->second;
+        if (base.accesses != res.accesses) {
+          status = "no-baseline(accesses differ)";
+        } else {
+          status.clear();
+          if (res.hit_rate() < base.hit_rate - hit_tolerance)
+            status += "REGRESSION(hit) ";
+          if (static_cast<double>(res.state_bytes) > static_cast<double>(base.state_bytes) * STATE_TOLERANCE)
+            status += "REGRESSION(state) ";
+          if (!status.empty())
+            ++failures;
+          // Timing depends on the host, so a slowdown is reported but not failed
+          if (res.ns_per_access > base.ns_per_access * TIME_TOLERANCE)
+            status += "slower ";
+          if (status.empty())
+            status = "ok";
+          else
+            status.pop_back();
+        }
+      } else if (!baseline.empty()) {
+        status = "no-baseline";
+      }
+
+      std::cout << std::left << std::setw(9) << p.name << std::setw(13) << pat.name << std::right << std::setw(10) << res.accesses << std::fixed
+                << std::setprecision(2) << std::setw(10) << res.hit_rate() << std::setw(10) << res.ns_per_access << std::setw(12) << res.state_bytes << "  "
+                << status << std::endl;
+
+      if (out.is_open())
+        out << p.name << " " << pat.name << " " << res.accesses << " " << std::fixed << std::setprecision(2) << res.hit_rate() << " " << res.ns_per_access
+            << " " << res.state_bytes << std::endl;
+    }
+  }
+
+  if (out.is_open() && !out.flush()) {
+    std::cerr << "Failed writing baseline " << write_path << std::endl;
+    return 2;
+  }
+
+  if (failures > 0)
+    std::cout << std::endl << failures << " check(s) failed" << std::endl;
+  return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,34 @@
+// Stub CACHE: geometry plus a block array, enough for the policy modules
+// to size their state and for the bench harness to do tag lookups.
+#ifndef BENCH_STUB_CACHE_H
+#define BENCH_STUB_CACHE_H
+
+#include <string>
+#include <vector>
+
+#include "champsim.h"
+
+enum class access_type : unsigned { LOAD = 0, RFO, PREFETCH, WRITE, TRANSLATION, NUM_TYPES };
+
+namespace champsim
+{
+struct cache_block {
+  bool valid = false;
+  champsim::address address{};
+  champsim::address v_address{};
+  uint64_t data = 0;
+};
+} // namespace champsim
+
+class CACHE
+{
+public:
+  const std::string NAME;
+  const long NUM_SET;
+  const long NUM_WAY;
+  std::vector<champsim::cache_block> block;
+
+  CACHE(std::string name, long sets, long ways) : NAME(std::move(name)), NUM_SET(sets), NUM_WAY(ways), block(static_cast<std::size_t>(sets * ways)) {}
+};
+
+#endif
@@ -0,0 +1,60 @@
+// Minimal stand-in for the ChampSim headers used by replacement/.
+// Only the pieces the policies touch are modeled, so the modules can be
+// built and driven outside the simulator by bench/replacement_bench.cc.
+#ifndef BENCH_STUB_CHAMPSIM_H
+#define BENCH_STUB_CHAMPSIM_H
+
+#include <cstddef>
+#include <cstdint>
+
+#ifndef BENCH_NUM_CPUS
+#define BENCH_NUM_CPUS 4
+#endif
+
+inline constexpr std::size_t NUM_CPUS = BENCH_NUM_CPUS;
+
+namespace champsim
+{
+constexpr unsigned lg2(uint64_t n) { return n < 2 ? 0 : 1 + lg2(n / 2); }
+
+namespace data
+{
+struct bits {
+  long long count;
+  constexpr explicit bits(long long n) : count(n) {}
+};
+
+namespace data_literals
+{
+}
+} // namespace data
+
+// 64-bit byte address with the slicing operations used by the policies
+class address
+{
+  uint64_t value = 0;
+
+public:
+  constexpr address() = default;
+  constexpr explicit address(uint64_t v) : value(v) {}
+
+  template <typename T>
+  constexpr T to() const
+  {
+    return static_cast<T>(value);
+  }
+
+  template <data::bits N>
+  constexpr address slice_lower() const
+  {
+    return address{N.count >= 64 ? value : value & ((uint64_t{1} << N.count) - 1)};
+  }
+
+  constexpr address slice_upper(data::bits n) const { return address{n.count >= 64 ? 0 : value >> n.count}; }
+
+  friend constexpr bool operator==(const address& lhs, const address& rhs) { return lhs.value == rhs.value; }
+  friend constexpr bool operator!=(const address& lhs, const address& rhs) { return lhs.value != rhs.value; }
+};
+} // namespace champsim
+
+#endif
@@ -0,0 +1,14 @@
+#ifndef BENCH_STUB_MODULES_H
+#define BENCH_STUB_MODULES_H
+
+class CACHE;
+
+namespace champsim::modules
+{
+struct replacement {
+  CACHE* intern_;
+  explicit replacement(CACHE* cache) : intern_(cache) {}
+};
+} // namespace champsim::modules
+
+#endif
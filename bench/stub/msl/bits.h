@@ -0,0 +1,11 @@
+#ifndef BENCH_STUB_MSL_BITS_H
+#define BENCH_STUB_MSL_BITS_H
+
+#include <cstdint>
+
+namespace champsim::msl
+{
+constexpr unsigned lg2(uint64_t n) { return n < 2 ? 0 : 1 + lg2(n / 2); }
+} // namespace champsim::msl
+
+#endif
@@ -0,0 +1,51 @@
+#ifndef BENCH_STUB_MSL_FWCOUNTER_H
+#define BENCH_STUB_MSL_FWCOUNTER_H
+
+#include <cstddef>
+
+namespace champsim::msl
+{
+// Saturating counter of fixed width, mirroring ChampSim's msl::fwcounter
+template <std::size_t WIDTH>
+class fwcounter
+{
+  static constexpr long maximum = (1L << WIDTH) - 1;
+  long val = 0;
+
+public:
+  constexpr fwcounter() = default;
+  constexpr explicit fwcounter(long v) : val(v < 0 ? 0 : (v > maximum ? maximum : v)) {}
+
+  constexpr long value() const { return val; }
+
+  fwcounter& operator++()
+  {
+    if (val < maximum)
+      ++val;
+    return *this;
+  }
+
+  fwcounter& operator--()
+  {
+    if (val > 0)
+      --val;
+    return *this;
+  }
+
+  fwcounter operator++(int)
+  {
+    auto old = *this;
+    ++*this;
+    return old;
+  }
+
+  fwcounter operator--(int)
+  {
+    auto old = *this;
+    --*this;
+    return old;
+  }
+};
+} // namespace champsim::msl
+
+#endif
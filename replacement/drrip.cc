@@ -1,4 +1,5 @@
 #include "drrip.h"
+#include <array>
 #include <iostream>
 #include <iomanip>
 #include <random>
@@ -6,7 +7,10 @@
 
 // Constructor for the drrip class, initializes cache parameters and data structures
 drrip::drrip(CACHE* cache)
-  : champsim::modules::replacement(cache)
+  : champsim::modules::replacement(cache),
+    telemetry_stream("drrip", cache->NAME,
+                     {"hit_rate", "psel_min", "psel_mean", "psel_max", "psel_srrip_groups",
+                      "rrpv_0", "rrpv_1", "rrpv_2", "rrpv_3", "bip_inserts", "srrip_inserts"})
 {
   NUM_SET = 2048; // Number of sets in the cache
   NUM_WAY = 16;   // Number of ways in the cache
@@ -20,6 +24,8 @@ drrip::drrip(CACHE* cache)
   // Identify SDM (Set Dueling Monitor) sets
   for (std::size_t i = 0; i < NUM_SET; i += SDM_SIZE)
     sdm_sets.push_back(i);
+
+  telemetry_row.resize(telemetry_stream.columns());
 }
 
 // Helper function to get the RRPV value for a specific set and way
@@ -48,6 +54,15 @@ long drrip::find_victim(uint32_t cpu, uint64_t instr_id, long set,
   }
 }
 
+// Function to update the replacement state when a block is filled on a miss
+void drrip::replacement_cache_fill(uint32_t cpu, long set, long way,
+                                   champsim::address addr, champsim::address ip,
+                                   champsim::address victim_addr, access_type type)
+{
+  // ChampSim only calls update_replacement_state on hits, so fills run the miss path here
+  update_replacement_state(cpu, set, way, addr, ip, victim_addr, type, 0);
+}
+
 // Function to update the replacement state after a cache access
 void drrip::update_replacement_state(uint32_t cpu, long set, long way,
                                      champsim::address addr, champsim::address ip,
@@ -92,11 +107,47 @@ void drrip::update_replacement_state(uint32_t cpu, long set, long way,
     else update_bip(set, way);
   }
 
-  // Periodically record the hit rate
-  if (access_counter % HIT_RATE_SAMPLE_INTERVAL == 0) {
-    double rate = 100.0 * static_cast<double>(hit_counter) / static_cast<double>(access_counter);
-    hit_rate_history.push_back(rate);
+  // Periodically record the internal state
+  if (access_counter % telemetry::SAMPLE_INTERVAL == 0 && telemetry_stream.enabled())
+    record_telemetry();
+}
+
+// Function to sample the policy state over the last interval into the telemetry stream
+void drrip::record_telemetry() {
+  auto row = telemetry_row.begin();
+
+  // Hit rate over the interval, not cumulative, so phase changes stand out
+  *row++ = static_cast<float>(hit_counter - last_sample_hits) / telemetry::SAMPLE_INTERVAL;
+
+  // PSEL spread and how many groups currently favor SRRIP
+  long psel_min = PSEL.front().value(), psel_max = psel_min, psel_sum = 0, srrip_groups = 0;
+  for (const auto& counter : PSEL) {
+    psel_min = std::min<long>(psel_min, counter.value());
+    psel_max = std::max<long>(psel_max, counter.value());
+    psel_sum += counter.value();
+    if (counter.value() > (1 << (PSEL_WIDTH - 1)))
+      srrip_groups++;
   }
+  *row++ = static_cast<float>(psel_min);
+  *row++ = static_cast<float>(psel_sum) / static_cast<float>(PSEL.size());
+  *row++ = static_cast<float>(psel_max);
+  *row++ = static_cast<float>(srrip_groups);
+
+  // Number of blocks at each RRPV
+  std::array<uint32_t, MAX_RRPV + 1> occupancy{};
+  for (auto value : rrpv)
+    occupancy[value]++;
+  for (auto count : occupancy)
+    *row++ = static_cast<float>(count);
+
+  // Insertions made by each policy over the interval
+  *row++ = static_cast<float>(bip_inserts - last_sample_bip);
+  *row++ = static_cast<float>(srrip_inserts - last_sample_srrip);
+
+  telemetry_stream.record(access_counter, telemetry_row);
+  last_sample_hits = hit_counter;
+  last_sample_bip = bip_inserts;
+  last_sample_srrip = srrip_inserts;
 }
 
 // Function to update the state for SRRIP (Static Re-Reference Interval Prediction)
@@ -107,11 +158,10 @@ void drrip::update_srrip(long set, long way) {
 
 // Function to update the state for BIP (Bimodal Insertion Policy)
 void drrip::update_bip(long set, long way) {
-  static std::mt19937 gen(std::random_device{}()); // Random number generator
-  static std::uniform_int_distribution<int> dist(0, BIP_MAX - 1); // Distribution for BIP decision
+  std::uniform_int_distribution<int> dist(0, BIP_MAX - 1); // Distribution for BIP decision
 
   // Insert with a low probability (bimodal behavior)
-  if (dist(gen) == 0)
+  if (dist(bip_rng) == 0)
     get_rrpv(set, way) = MAX_RRPV - 1; // Favor SRRIP-like behavior
   else
     get_rrpv(set, way) = MAX_RRPV; // Favor BIP-like behavior
@@ -2,22 +2,24 @@
 #ifndef REPLACEMENT_DRRIP_H
 #define REPLACEMENT_DRRIP_H
 
+#include <random>
 #include <vector>
 #include "cache.h"
 #include "modules.h"
 #include "msl/fwcounter.h"
+#include "telemetry.h"
 
 // DRRIP (Dynamic Re-Reference Interval Prediction) replacement policy class
 struct drrip : public champsim::modules::replacement {
 private:
   unsigned& get_rrpv(long set, long way);
+  void record_telemetry();
 
 public:
   static constexpr unsigned MAX_RRPV = 3; // Maximum RRPV value
   static constexpr std::size_t BIP_MAX = 32; // Probability denominator for BIP (Bimodal Insertion Policy)
   static constexpr std::size_t SDM_SIZE = 32; // Size of Set Dueling Monitor (SDM) groups
   static constexpr std::size_t PSEL_WIDTH = 10; // Width of the PSEL (Policy Selector) counter
-  static constexpr std::size_t HIT_RATE_SAMPLE_INTERVAL = 100000; // Interval for sampling hit rate
 
   
   unsigned NUM_SET = 0; 
@@ -26,6 +28,7 @@ public:
   std::vector<unsigned> rrpv; // RRPV table for all cache blocks
   std::vector<std::size_t> sdm_sets; // List of SDM sets
   std::vector<champsim::msl::fwcounter<PSEL_WIDTH>> PSEL; // PSEL counters for SDM groups
+  std::minstd_rand bip_rng{1}; // Fixed seed so runs over the same accesses are repeatable
 
   
   uint64_t access_counter = 0; // Total number of cache accesses
@@ -39,7 +42,12 @@ public:
   uint64_t rrpv_sum_on_hits = 0; // Sum of RRPV values on cache hits
   uint64_t rrpv_hit_count = 0; // Number of cache hits used for RRPV statistics
 
-  std::vector<double> hit_rate_history; // History of sampled hit rates
+  // Samples of hit rate, PSEL, RRPV occupancy and insertion mix every telemetry::SAMPLE_INTERVAL accesses
+  telemetry::recorder telemetry_stream;
+  std::vector<float> telemetry_row; // Reused for every sample so recording never allocates
+  uint64_t last_sample_hits = 0; // hit_counter at the previous sample
+  uint64_t last_sample_bip = 0; // bip_inserts at the previous sample
+  uint64_t last_sample_srrip = 0; // srrip_inserts at the previous sample
 
   // Constructor to initialize the DRRIP replacement policy
   drrip(CACHE* cache);
@@ -48,6 +56,10 @@ public:
   long find_victim(uint32_t cpu, uint64_t instr_id, long set, const champsim::cache_block* set_blocks,
                    champsim::address ip, champsim::address addr, access_type type);
 
+  // Function to update the replacement state when a block is filled on a miss
+  void replacement_cache_fill(uint32_t cpu, long set, long way, champsim::address addr, champsim::address ip,
+                              champsim::address victim_addr, access_type type);
+
   // Function to update the replacement state after a cache access
   void update_replacement_state(uint32_t cpu, long set, long way, champsim::address addr, champsim::address ip,
                                 champsim::address victim_addr, access_type type, uint8_t hit);
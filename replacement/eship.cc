@@ -5,6 +5,9 @@
 #include <random>
 #include <cmath>
 #include <iostream>
+#include <limits>
+#include <numeric>
+#include <string>
 
 #include "champsim.h"
 
@@ -19,7 +22,11 @@ eship::eship(CACHE* cache)
       access_history(NUM_CPUS),
       sampler(SAMPLER_SET_FACTOR * NUM_CPUS * static_cast<std::size_t>(NUM_WAY)),
       rrpv_values(static_cast<std::size_t>(NUM_SET * NUM_WAY), maxRRPV),
-      frequency_counters(static_cast<std::size_t>(NUM_SET * NUM_WAY), 0)
+      frequency_counters(static_cast<std::size_t>(NUM_SET * NUM_WAY), 0),
+      telemetry_stream("eship", cache->NAME, telemetry_columns()),
+      telemetry_row(telemetry_stream.columns()),
+      last_sample_hits(NUM_CPUS, 0),
+      last_sample_accesses(NUM_CPUS, 0)
 {
     // randomly selected sampler sets
     std::knuth_b rng(1);
@@ -44,6 +51,59 @@ eship::eship(CACHE* cache)
     }
 }
 
+std::vector<std::string> eship::telemetry_columns() {
+    std::vector<std::string> columns;
+    for (uint32_t cpu = 0; cpu < NUM_CPUS; cpu++) {
+        auto prefix = "cpu" + std::to_string(cpu) + "_";
+        for (const auto* name : {"hit_rate", "weight_load", "weight_rfo", "weight_prefetch", "weight_write"})
+            columns.push_back(prefix + name);
+    }
+    columns.push_back("sampler_hit_rate");
+    for (unsigned i = 0; i <= SHCT_MAX; i++)
+        columns.push_back("shct_" + std::to_string(i));
+    for (int i = 0; i <= maxRRPV; i++)
+        columns.push_back("rrpv_" + std::to_string(i));
+    return columns;
+}
+
+void eship::record_telemetry(uint64_t total_accesses) {
+    // rates over an interval with no accesses are undefined, not 0
+    constexpr float NO_DATA = std::numeric_limits<float>::quiet_NaN();
+    auto row = telemetry_row.begin();
+
+    // per-CPU hit rate over the interval and current type weights
+    for (uint32_t cpu = 0; cpu < NUM_CPUS; cpu++) {
+        auto interval_accesses = accesses[cpu] - last_sample_accesses[cpu];
+        auto interval_hits = hits[cpu] - last_sample_hits[cpu];
+        *row++ = interval_accesses == 0 ? NO_DATA : static_cast<float>(interval_hits) / interval_accesses;
+        row = std::copy(std::begin(type_weights[cpu]), std::end(type_weights[cpu]), row);
+
+        last_sample_accesses[cpu] = accesses[cpu];
+        last_sample_hits[cpu] = hits[cpu];
+    }
+
+    *row++ = sampler_accesses == 0 ? NO_DATA : static_cast<float>(sampler_hits) / sampler_accesses;
+    sampler_accesses = 0;
+    sampler_hits = 0;
+
+    // how many SHCT entries sit at each counter value, across all CPUs
+    std::array<uint32_t, SHCT_MAX + 1> shct_histogram{};
+    for (const auto& table : SHCT)
+        for (const auto& counter : table)
+            shct_histogram[counter.value()]++;
+    for (auto count : shct_histogram)
+        *row++ = static_cast<float>(count);
+
+    // number of blocks at each RRPV
+    std::array<uint32_t, maxRRPV + 1> occupancy{};
+    for (auto value : rrpv_values)
+        occupancy[value]++;
+    for (auto count : occupancy)
+        *row++ = static_cast<float>(count);
+
+    telemetry_stream.record(total_accesses, telemetry_row);
+}
+
 int& eship::get_rrpv(long set, long way) {
     return rrpv_values.at(static_cast<std::size_t>(set * NUM_WAY + way));
 }
@@ -64,6 +124,13 @@ void eship::update_stats(uint32_t cpu, bool hit) {
     accesses[cpu]++;
     if (hit) hits[cpu]++;
 
+    // sample on the total across CPUs, so rows are evenly spaced like drrip's
+    if (telemetry_stream.enabled()) {
+        auto total_accesses = std::accumulate(std::begin(accesses), std::end(accesses), uint64_t{0});
+        if (total_accesses % telemetry::SAMPLE_INTERVAL == 0)
+            record_telemetry(total_accesses);
+    }
+
     // recalculate hit ratio every 1000 accesses
     if (accesses[cpu] % 1000 == 0) {
         hit_ratio[cpu] = static_cast<double>(hits[cpu]) / accesses[cpu];
@@ -133,7 +200,14 @@ long eship::find_victim(uint32_t triggering_cpu, uint64_t instr_id, long set, co
     return best_victim->first;
 }
 
-// called on every cache hit and cache fill
+// called on every cache fill; ChampSim only calls update_replacement_state on hits
+void eship::replacement_cache_fill(uint32_t triggering_cpu, long set, long way, champsim::address full_addr,
+                                 champsim::address ip, champsim::address victim_addr, access_type type)
+{
+    update_replacement_state(triggering_cpu, set, way, full_addr, ip, victim_addr, type, 0);
+}
+
+// called on every cache hit, and on every fill through replacement_cache_fill
 void eship::update_replacement_state(uint32_t triggering_cpu, long set, long way, champsim::address full_addr,
                                    champsim::address ip, champsim::address victim_addr, access_type type, uint8_t hit)
 {
@@ -172,6 +246,8 @@ void eship::update_replacement_state(uint32_t triggering_cpu, long set, long way
         auto s_set_begin = std::next(std::begin(sampler), std::distance(std::begin(rand_sets), s_idx));
         auto s_set_end = std::next(s_set_begin, NUM_WAY);
 
+        sampler_accesses++;
+
         // check hit
         auto match = std::find_if(s_set_begin, s_set_end, [addr = full_addr, shamt = champsim::data::bits{8 + champsim::lg2(NUM_WAY)}](auto x) {
             return x.valid && x.address.slice_upper(shamt) == addr.slice_upper(shamt);
@@ -179,6 +255,7 @@ void eship::update_replacement_state(uint32_t triggering_cpu, long set, long way
 
         // if hit in sampler
         if (match != s_set_end) {
+            sampler_hits++;
             auto SHCT_idx = get_signature(match->ip);
 
             // decrement SHCT based on hit success prediction
@@ -268,7 +345,7 @@ void eship::update_replacement_state(uint32_t triggering_cpu, long set, long way
 void eship::replacement_final_stats() {
     std::cout << "ESHIP Replacement Policy Statistics:" << std::endl;
     for (uint32_t cpu = 0; cpu < NUM_CPUS; cpu++) {
-        std::cout << "CPU " << cpu << " Hit Ratio: " << hit_ratio[cpu] << std::endl;
+        std::cout << "CPU " << cpu << " Hit Ratio: " << hit_ratio[cpu] << " (" << hits[cpu] << " hits / " << accesses[cpu] << " accesses)" << std::endl;
         std::cout << "CPU " << cpu << " Type Weights: ";
         for (uint32_t i = 0; i < 4; i++) {
             std::cout << type_weights[cpu][i] << " ";
@@ -10,6 +10,7 @@
 #include "modules.h"
 #include "msl/bits.h"
 #include "msl/fwcounter.h"
+#include "telemetry.h"
 
 // ESHIP replacement policy
 struct eship : public champsim::modules::replacement {
@@ -18,6 +19,8 @@ private:
   uint32_t get_signature(champsim::address ip);
   void update_stats(uint32_t cpu, bool hit);
   void adjust_prediction_weights(uint32_t cpu);
+  static std::vector<std::string> telemetry_columns();
+  void record_telemetry(uint64_t total_accesses);
 
 public:
   // core ESHIP parameters
@@ -72,11 +75,24 @@ public:
   std::vector<std::array<champsim::msl::fwcounter<champsim::msl::lg2(FREQUENCY_MAX + 1)>, SHCT_SIZE>> frequency_table;
   std::vector<std::array<float, 4>> type_weights; // weights for different access types
 
+  // telemetry: per-CPU hit rate and type weights, sampler hit rate,
+  // SHCT saturation histogram and RRPV occupancy every telemetry::SAMPLE_INTERVAL
+  // accesses summed over all CPUs
+  telemetry::recorder telemetry_stream;
+  std::vector<float> telemetry_row;
+  uint64_t sampler_accesses = 0; // since the last sample
+  uint64_t sampler_hits = 0;     // since the last sample
+  std::vector<uint64_t> last_sample_hits;
+  std::vector<uint64_t> last_sample_accesses;
+
   explicit eship(CACHE* cache);
 
   long find_victim(uint32_t triggering_cpu, uint64_t instr_id, long set, const champsim::cache_block* current_set,
                   champsim::address ip, champsim::address full_addr, access_type type);
 
+  void replacement_cache_fill(uint32_t triggering_cpu, long set, long way, champsim::address full_addr,
+                              champsim::address ip, champsim::address victim_addr, access_type type);
+
   void update_replacement_state(uint32_t triggering_cpu, long set, long way, champsim::address full_addr,
                               champsim::address ip, champsim::address victim_addr, access_type type, uint8_t hit);
 
@@ -0,0 +1,249 @@
+#ifndef REPLACEMENT_TELEMETRY_H
+#define REPLACEMENT_TELEMETRY_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Periodic telemetry for replacement policy internals.
+//
+// A policy fills a row of float columns every SAMPLE_INTERVAL accesses and
+// hands it to a recorder. Rows go into a fixed-size single-producer/single-consumer ring, so
+// the simulation thread never blocks or allocates; a background thread drains
+// the ring and writes column-major blocks, each holding up to BLOCK_ROWS rows.
+// A partial block is written once FLUSH_PERIOD has passed, so a run that is
+// killed still leaves its samples on disk. When the ring is full the row is
+// dropped and counted rather than stalling the simulation.
+//
+// Telemetry is off unless REPLACEMENT_TELEMETRY_DIR is set. The file is
+// <dir>/<policy>.<cache name>.rptl, laid out as (native byte order):
+//   header:  "RPTL" | u32 version | u32 columns | per column: u16 length, name bytes
+//   block:   u32 rows (> 0) | rows x u64 access stamp | per column: rows x f32
+//   trailer: u32 0 | u64 dropped rows
+// Rates (hit rates, sampler hit rate) are fractions in [0, 1], or NaN when the
+// interval had no accesses to compute them from; counts and histogram bins are
+// stored as plain values.
+namespace telemetry
+{
+constexpr uint64_t SAMPLE_INTERVAL = 100000; // accesses between samples
+
+// Lock-free ring of fixed-width rows with one producer and one consumer
+class ring
+{
+  std::size_t columns;
+  std::size_t mask;
+  std::vector<uint64_t> stamps;
+  std::vector<float> values;
+  alignas(64) std::atomic<std::size_t> head{0}; // next slot the producer writes
+  alignas(64) std::atomic<std::size_t> tail{0}; // next slot the consumer reads
+
+public:
+  // capacity must be a power of two
+  ring(std::size_t capacity, std::size_t cols) : columns(cols), mask(capacity - 1), stamps(capacity), values(capacity * cols) {}
+
+  bool try_push(uint64_t stamp, const float* row)
+  {
+    auto h = head.load(std::memory_order_relaxed);
+    if (h - tail.load(std::memory_order_acquire) > mask)
+      return false;
+
+    auto slot = h & mask;
+    stamps[slot] = stamp;
+    std::copy(row, row + columns, std::next(std::begin(values), static_cast<long>(slot * columns)));
+    head.store(h + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool try_pop(uint64_t& stamp, float* row)
+  {
+    auto t = tail.load(std::memory_order_relaxed);
+    if (t == head.load(std::memory_order_acquire))
+      return false;
+
+    auto slot = t & mask;
+    stamp = stamps[slot];
+    auto begin = std::next(std::begin(values), static_cast<long>(slot * columns));
+    std::copy(begin, std::next(begin, static_cast<long>(columns)), row);
+    tail.store(t + 1, std::memory_order_release);
+    return true;
+  }
+};
+
+class recorder
+{
+public:
+  static constexpr std::size_t RING_ROWS = 4096;  // rows buffered between the simulation and the writer
+  static constexpr std::size_t BLOCK_ROWS = 1024; // rows per column-major block on disk
+  static constexpr std::chrono::seconds FLUSH_PERIOD{5}; // longest a sample waits in memory before reaching disk
+
+  recorder(const std::string& policy, const std::string& cache_name, std::vector<std::string> column_names) : names(std::move(column_names))
+  {
+    const char* dir = std::getenv("REPLACEMENT_TELEMETRY_DIR");
+    if (dir == nullptr || *dir == '\0')
+      return;
+
+    // Only pay for the ring and writer when telemetry is actually being written
+    auto writer_state = std::make_unique<impl>(std::string{dir} + "/" + policy + "." + cache_name + ".rptl", names);
+    if (writer_state->writer.joinable())
+      state = std::move(writer_state);
+  }
+
+  // The writer thread only holds a pointer to impl, so the recorder (and the
+  // policy that owns it) can be moved freely
+  recorder(recorder&&) noexcept = default;
+  recorder& operator=(recorder&&) noexcept = default;
+
+  bool enabled() const { return state != nullptr; }
+  std::size_t columns() const { return names.size(); }
+
+  // Called from the simulation thread when enabled(); never blocks
+  void record(uint64_t stamp, const std::vector<float>& row)
+  {
+    if (!state->buffer.try_push(stamp, row.data()))
+      ++state->dropped;
+  }
+
+private:
+  struct impl {
+    ring buffer;
+    std::string path;
+    std::ofstream out;
+    bool failed = false; // set once a write fails; later rows are drained and discarded
+    std::size_t columns;
+    std::atomic<bool> stopping{false};
+    // Written by the producer only; drain() reads it after seeing stopping, and
+    // the release/acquire pair on stopping orders the last increment before that read
+    uint64_t dropped = 0;
+    std::thread writer;
+
+    impl(const std::string& file, const std::vector<std::string>& names)
+        : buffer(RING_ROWS, names.size()), path(file), out(path, std::ios::binary), columns(names.size())
+    {
+      if (!out) {
+        std::cerr << "Telemetry: could not open " << path << std::endl;
+        return;
+      }
+      write_header(names);
+      out.flush();
+      if (!check_stream())
+        return;
+      writer = std::thread{[this]() { drain(); }};
+    }
+
+    impl(const impl&) = delete;
+    impl& operator=(const impl&) = delete;
+
+    ~impl()
+    {
+      if (!writer.joinable())
+        return;
+      stopping.store(true, std::memory_order_release);
+      writer.join();
+    }
+
+    // Report the first failed write (e.g. a full disk) instead of silently losing samples
+    bool check_stream()
+    {
+      if (!failed && !out) {
+        failed = true;
+        std::cerr << "Telemetry: writing " << path << " failed, discarding further samples" << std::endl;
+      }
+      return !failed;
+    }
+
+    template <typename T>
+    void put(const T& value)
+    {
+      out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void write_header(const std::vector<std::string>& names)
+    {
+      out.write("RPTL", 4);
+      put<uint32_t>(1);
+      put<uint32_t>(static_cast<uint32_t>(names.size()));
+      for (const auto& name : names) {
+        put<uint16_t>(static_cast<uint16_t>(name.size()));
+        out.write(name.data(), static_cast<std::streamsize>(name.size()));
+      }
+    }
+
+    void write_block(const std::vector<uint64_t>& stamps, const std::vector<float>& rows)
+    {
+      const auto count = stamps.size();
+      put<uint32_t>(static_cast<uint32_t>(count));
+      out.write(reinterpret_cast<const char*>(stamps.data()), static_cast<std::streamsize>(count * sizeof(uint64_t)));
+
+      // Transpose the row-major staging area into one run per column
+      std::vector<float> column(count);
+      for (std::size_t c = 0; c < columns; ++c) {
+        for (std::size_t r = 0; r < count; ++r)
+          column[r] = rows[r * columns + c];
+        out.write(reinterpret_cast<const char*>(column.data()), static_cast<std::streamsize>(count * sizeof(float)));
+      }
+    }
+
+    void drain()
+    {
+      std::vector<uint64_t> stamps;
+      std::vector<float> rows;
+      std::vector<float> row(columns);
+      stamps.reserve(BLOCK_ROWS);
+      rows.reserve(BLOCK_ROWS * columns);
+
+      auto last_flush = std::chrono::steady_clock::now();
+      auto flush = [&]() {
+        if (!stamps.empty() && !failed) {
+          write_block(stamps, rows);
+          out.flush();
+          check_stream();
+        }
+        stamps.clear();
+        rows.clear();
+        last_flush = std::chrono::steady_clock::now();
+      };
+
+      while (true) {
+        // Read the stop flag first so no row pushed before it was set is missed
+        const bool last_pass = stopping.load(std::memory_order_acquire);
+
+        uint64_t stamp;
+        while (buffer.try_pop(stamp, row.data())) {
+          stamps.push_back(stamp);
+          rows.insert(std::end(rows), std::begin(row), std::end(row));
+          if (stamps.size() == BLOCK_ROWS)
+            flush();
+        }
+
+        if (last_pass)
+          break;
+        if (!stamps.empty() && std::chrono::steady_clock::now() - last_flush >= FLUSH_PERIOD)
+          flush();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      }
+
+      flush();
+      if (failed)
+        return;
+      put<uint32_t>(0);
+      put<uint64_t>(dropped);
+      out.flush();
+      check_stream();
+    }
+  };
+
+  std::vector<std::string> names;
+  std::unique_ptr<impl> state;
+};
+} // namespace telemetry
+
+#endif